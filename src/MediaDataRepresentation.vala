@@ -173,6 +173,29 @@ public abstract class MediaSource : ThumbnailSource, Indexable {
         return prepare_input_text(comment,
             PrepareInputTextOptions.DEFAULT & ~PrepareInputTextOptions.STRIP_CRLF & ~PrepareInputTextOptions.EMPTY_IS_NULL, -1);
     }
+
+    // Orders media by file name, then by id
+    public static int64 compare_filename(MediaSource a, MediaSource b) {
+        string path_a = a.get_file().get_basename().down();
+        string path_b = b.get_file().get_basename().down();
+        if (!path_a.validate()) {
+            path_a = Uri.escape_string(path_a, Uri.RESERVED_CHARS_ALLOWED_IN_PATH, true);
+        }
+
+        if (!path_b.validate()) {
+            path_b = Uri.escape_string(path_b, Uri.RESERVED_CHARS_ALLOWED_IN_PATH, true);
+        }
+
+        int64 result = strcmp(path_a.collate_key_for_filename(), path_b.collate_key_for_filename());
+        return (result != 0) ? result : a.get_instance_id() - b.get_instance_id();
+    }
+
+    // Orders media by exposure time, then by file name and id
+    public static int64 compare_exposure_time(MediaSource a, MediaSource b) {
+        var result = nullsafe_date_time_comperator(a.get_exposure_time(), b.get_exposure_time());
+
+        return (result != 0) ? result : compare_filename(a, b);
+    }
     
     public abstract Rating get_rating();
     public abstract void set_rating(Rating rating);
@@ -56,6 +56,7 @@ public enum ConfigurableProperty {
     EXPORT_SCALE,
     EXTERNAL_PHOTO_APP,
     EXTERNAL_RAW_APP,
+    FACE_DETECTION_HELPER_THREADS,
     HIDE_PHOTOS_ALREADY_IMPORTED,
     IMPORT_DIR,
     KEEP_RELATIVITY,
@@ -207,6 +208,9 @@ public enum ConfigurableProperty {
                 
             case EXTERNAL_RAW_APP:
                 return "EXTERNAL_RAW_APP";
+
+            case FACE_DETECTION_HELPER_THREADS:
+                return "FACE_DETECTION_HELPER_THREADS";
             
             case HIDE_PHOTOS_ALREADY_IMPORTED:
                 return "HIDE_PHOTOS_ALREADY_IMPORTED";
@@ -1002,6 +1006,20 @@ public abstract class ConfigurationFacade : Object {
         }
     }
 
+    //
+    // face detection helper threads
+    //
+    public virtual int get_face_detection_helper_threads() {
+        try {
+            return get_engine().get_int_property(ConfigurableProperty.FACE_DETECTION_HELPER_THREADS);
+        } catch (ConfigurationError err) {
+            on_configuration_error(err);
+
+            // let the face detection code pick a value
+            return 0;
+        }
+    }
+
     //
     // export dialog settings
     //
@@ -354,10 +354,7 @@ public class Face : DataSource, ContainerSource, Proxyable, Indexable {
     }
     
     public static void terminate() {
-        try {
-            if (FaceDetect.face_detect_proxy != null)
-                FaceDetect.face_detect_proxy.terminate();
-        } catch(Error e) {}
+        FaceDetect.terminate();
     }
     
     public static int compare_names(void *a, void *b) {
@@ -36,12 +36,183 @@ public struct FaceRect {
 public interface FaceDetectInterface : DBusProxy {
     public abstract async FaceRect[] detect_faces(string inputName, string cascadeName, double scale, bool infer, Cancellable? cancellable)
         throws IOError, DBusError;
-    public abstract bool load_net(string netFile)
+    public abstract async FaceRect[] detect_faces_related(string inputName, string cascadeName, double scale, bool infer,
+                                                          string id, string related, Cancellable? cancellable)
+        throws IOError, DBusError;
+    public abstract async bool load_net(string netFile)
         throws IOError, DBusError;
     public abstract void terminate() throws IOError, DBusError;
     public abstract async bool can_read(string inputName) throws IOError, DBusError;
 }
 
+#if FACEDETECT_BUS_PRIVATE
+// The facedetect process, talking to us over a private DBus server.
+// If the process goes away unexpectedly, it is started again.
+private class FaceDetectHelper : Object {
+    // Give up on a helper that crashed more than MAX_RESPAWNS times within RESPAWN_WINDOW
+    // on its own. Crashes while handling a request are blamed on the input instead
+    private const int MAX_RESPAWNS = 5;
+    private const int64 RESPAWN_WINDOW = 60 * TimeSpan.SECOND;
+    private const uint RESPAWN_DELAY_SEC = 1;
+
+    public int threads { get; private set; }
+    public FaceDetectInterface? proxy { get; private set; default = null; }
+
+    private GLib.DBusServer dbus_server;
+    private Subprocess? process = null;
+    private bool shutting_down = false;
+    private int respawns = 0;
+    private int64 respawn_window_start = 0;
+    private uint respawn_id = 0;
+    // Requests currently running, and whether the last one failed
+    private int pending = 0;
+    private bool request_failed = false;
+
+    public FaceDetectHelper(int threads) {
+        this.threads = threads;
+    }
+
+    public void start(string address, DBusAuthObserver observer) throws Error {
+        dbus_server = new GLib.DBusServer.sync(address, DBusServerFlags.NONE, DBus.generate_guid(), observer, null);
+        dbus_server.new_connection.connect(on_new_connection);
+        dbus_server.start();
+        spawn();
+    }
+
+    public void request_started() {
+        pending++;
+        request_failed = false;
+    }
+
+    public void request_finished(bool failed) {
+        pending--;
+        request_failed = failed;
+
+        // The helper works, so earlier crashes were not its own fault
+        if (!failed)
+            respawns = 0;
+    }
+
+    public void terminate() {
+        shutting_down = true;
+        if (respawn_id != 0) {
+            Source.remove(respawn_id);
+            respawn_id = 0;
+        }
+
+        if (proxy != null) {
+            try {
+                proxy.terminate();
+
+                return;
+            } catch (Error e) {}
+        }
+
+        // Not connected yet, or not answering
+        if (process != null)
+            process.force_exit();
+    }
+
+    private void spawn() throws Error {
+        debug("Starting face detect helper with %d threads", threads);
+        process = new Subprocess(SubprocessFlags.NONE, AppDirs.get_facedetect_bin().get_path(),
+            "--address=" + dbus_server.get_client_address(), "--threads=%d".printf(threads));
+        watch_process.begin(process);
+    }
+
+    private async void watch_process(Subprocess watched) {
+        try {
+            yield watched.wait_async(null);
+        } catch (Error error) {
+            warning("Failed to wait for face detect helper: %s", error.message);
+        }
+
+        // Already replaced by a newer process
+        if (process != watched)
+            return;
+
+        var was_connected = FaceDetect.connected;
+        var during_request = pending > 0 || request_failed;
+        request_failed = false;
+
+        process = null;
+        proxy = null;
+        FaceDetect.connected = false;
+
+        if (shutting_down)
+            return;
+
+        if (watched.get_if_signaled()) {
+            warning("Face detect helper was killed by signal %d", watched.get_term_sig());
+        } else {
+            warning("Face detect helper exited with status %d", watched.get_exit_status());
+        }
+
+        // A corrupt file crashing the helper should not disable face detection
+        // for the whole session, so only count crashes that are not caused by a request
+        if (!was_connected || !during_request) {
+            var now = get_monotonic_time();
+            if (now - respawn_window_start > RESPAWN_WINDOW) {
+                respawn_window_start = now;
+                respawns = 0;
+            }
+
+            if (++respawns > MAX_RESPAWNS) {
+                critical("Face detect helper keeps crashing, not restarting it");
+                AppWindow.get_instance().add_toast(new Shotwell.Toast(FaceDetect.CRASH_MESSAGE));
+
+                return;
+            }
+        }
+
+        respawn_id = Timeout.add_seconds_once(RESPAWN_DELAY_SEC, () => {
+            respawn_id = 0;
+            if (shutting_down)
+                return;
+
+            try {
+                spawn();
+            } catch (Error error) {
+                critical("Failed to restart face detect helper: %s", error.message);
+            }
+        });
+    }
+
+    private bool on_new_connection(DBusServer server, DBusConnection connection) {
+        try {
+            FaceDetectInterface new_proxy = connection.get_proxy_sync(null, FaceDetect.DBUS_PATH,
+                                                                      DBusProxyFlags.DO_NOT_LOAD_PROPERTIES
+                                                                      | DBusProxyFlags.DO_NOT_CONNECT_SIGNALS,
+                                                                      null);
+            proxy = new_proxy;
+            load_net.begin(new_proxy);
+
+            return true;
+        } catch (Error error) {
+            critical("Failed to create face_detect_proxy for face detect: %s", error.message);
+            AppWindow.error_message(FaceDetect.ERROR_MESSAGE);
+
+            return false;
+        }
+    }
+
+    private async void load_net(FaceDetectInterface new_proxy) {
+        try {
+            yield new_proxy.load_net(FaceDetect.net_file);
+
+            // The helper went away or was replaced in the meantime
+            if (proxy != new_proxy)
+                return;
+
+            FaceDetect.connected = true;
+        } catch (Error error) {
+            critical("Failed to call load_net: %s", error.message);
+            AppWindow.get_instance().add_toast(new Shotwell.Toast(FaceDetect.ERROR_MESSAGE));
+        }
+    }
+}
+#endif
+
 // Class to communicate with facedetect process over DBus
 public class FaceDetect {
     public const string DBUS_NAME = "org.gnome.Shotwell.Faces1";
@@ -49,13 +220,12 @@ public class FaceDetect {
     public static bool connected = false;
     public static string net_file;
     public const string ERROR_MESSAGE = "Unable to connect to facedetect service";
-    
-    public static FaceDetectInterface face_detect_proxy;
+    public const string CRASH_MESSAGE = "Facedetect service keeps crashing, face detection disabled";
 
 #if FACEDETECT_BUS_PRIVATE
-    private static GLib.DBusServer dbus_server;
-    private static Subprocess process;
-#endif
+    private static FaceDetectHelper? helper = null;
+#else
+    private static FaceDetectInterface face_detect_proxy;
 
     public static void create_face_detect_proxy(DBusConnection connection, string bus_name, string owner) {
         if (bus_name == DBUS_NAME) {
@@ -64,48 +234,93 @@ public class FaceDetect {
             try {
                 // Service file should automatically run the facedetect binary
                 face_detect_proxy = Bus.get_proxy_sync (BusType.SESSION, DBUS_NAME, DBUS_PATH);
-                face_detect_proxy.load_net(net_file);
-                connected = true;
-            } catch(IOError e) {
-                AppWindow.get_instance().add_toast(new Shotwell.Toast(ERROR_MESSAGE));
-            } catch(DBusError e) {
+                load_net.begin(face_detect_proxy);
+            } catch(Error e) {
                 AppWindow.get_instance().add_toast(new Shotwell.Toast(ERROR_MESSAGE));
             }
         }
     }
 
+    private static async void load_net(FaceDetectInterface proxy) {
+        try {
+            yield proxy.load_net(net_file);
+            if (proxy == face_detect_proxy)
+                connected = true;
+        } catch(Error e) {
+            AppWindow.get_instance().add_toast(new Shotwell.Toast(ERROR_MESSAGE));
+        }
+    }
+
     public static void interface_gone(DBusConnection connection, string bus_name) {
         message("Dbus name %s gone", bus_name);
         connected = false;
         face_detect_proxy = null;
     }
+#endif
 
+    private static FaceDetectInterface get_proxy() throws Error {
 #if FACEDETECT_BUS_PRIVATE
-    private static bool on_new_connection(DBusServer server, DBusConnection connection) {
+        FaceDetectInterface? proxy = (helper != null && connected) ? helper.proxy : null;
+#else
+        FaceDetectInterface? proxy = face_detect_proxy;
+#endif
+        if (proxy == null)
+            throw new IOError.NOT_CONNECTED(ERROR_MESSAGE);
+
+        return proxy;
+    }
+
+    public static async bool can_read(string path) throws Error {
+        return yield get_proxy().can_read(path);
+    }
+
+    // id identifies the photo in path. If set, related may name a photo detected
+    // before that is likely part of the same burst, so the helper can reuse its
+    // faces if both photos look alike
+    public static async FaceRect[] detect_faces(string path, string cascade, double scale, bool infer,
+                                                string? id, string? related,
+                                                Cancellable? cancellable) throws Error {
+        var proxy = get_proxy();
+#if FACEDETECT_BUS_PRIVATE
+        // A helper crashing on this file only fails this request, the helper
+        // is restarted for the next one
+        var current = helper;
+        current.request_started();
         try {
-            face_detect_proxy = connection.get_proxy_sync(null, DBUS_PATH,
-                                                  DBusProxyFlags.DO_NOT_LOAD_PROPERTIES
-                                                  | DBusProxyFlags.DO_NOT_CONNECT_SIGNALS,
-                                                  null);
-            Idle.add_once(() => {
-                try {
-                    face_detect_proxy.load_net(net_file);
-                    connected = true;
-                } catch (Error error) {
-                    critical("Failed to call load_net: %s", error.message);
-                    AppWindow.get_instance().add_toast(new Shotwell.Toast(ERROR_MESSAGE));
-                }
-            });
+            var rects = yield detect_faces_on(proxy, path, cascade, scale, infer, id, related, cancellable);
+            current.request_finished(false);
 
-            return true;
+            return rects;
         } catch (Error error) {
-            critical("Failed to create face_detect_proxy for face detect: %s", error.message);
-            AppWindow.error_message(ERROR_MESSAGE);
+            current.request_finished(true);
 
-            return false;
+            throw error;
         }
+#else
+        return yield detect_faces_on(proxy, path, cascade, scale, infer, id, related, cancellable);
+#endif
+    }
+
+    private static async FaceRect[] detect_faces_on(FaceDetectInterface proxy, string path, string cascade,
+                                                    double scale, bool infer, string? id, string? related,
+                                                    Cancellable? cancellable) throws Error {
+        if (id == null)
+            return yield proxy.detect_faces(path, cascade, scale, infer, cancellable);
+
+        return yield proxy.detect_faces_related(path, cascade, scale, infer, id, related ?? "", cancellable);
     }
+
+    public static void terminate() {
+#if FACEDETECT_BUS_PRIVATE
+        if (helper != null)
+            helper.terminate();
+#else
+        try {
+            if (face_detect_proxy != null)
+                face_detect_proxy.terminate();
+        } catch(Error e) {}
 #endif
+    }
     
     public static void init(string net_file) {
         FaceDetect.net_file = net_file;
@@ -126,13 +341,13 @@ public class FaceDetect {
             }
         });
 
-        try {
-            dbus_server = new GLib.DBusServer.sync(address, DBusServerFlags.NONE, DBus.generate_guid(), observer, null);
-            dbus_server.new_connection.connect(on_new_connection);
-            dbus_server.start();
-            process = new Subprocess(SubprocessFlags.NONE, AppDirs.get_facedetect_bin().get_path(),
-            "--address=" + dbus_server.get_client_address());
+        var threads = Config.Facade.get_instance().get_face_detection_helper_threads();
+        if (threads <= 0)
+            threads = (int) get_num_processors();
 
+        try {
+            helper = new FaceDetectHelper(threads);
+            helper.start(address, observer);
         } catch (Error error) {
             warning("Failed to create private DBus server: %s", error.message);
             AppWindow.error_message(ERROR_MESSAGE);
@@ -336,6 +336,8 @@ public class FacesTool : EditingTools.EditingTool {
     private FaceShape editing_face_shape = null;
     private FacesToolWindow faces_tool_window = null;
     private const int FACE_DETECT_MAX_WIDTH = 1200;
+    // Shots of a burst or bracketed series are at most this far apart
+    private const int64 SERIES_MAX_INTERVAL = 10 * TimeSpan.SECOND;
 
     private FacesTool() {
         base("FacesTool");
@@ -832,7 +834,7 @@ public class FacesTool : EditingTools.EditingTool {
         float scale_factor = (float)dimensions.width / FACE_DETECT_MAX_WIDTH;
         var path = canvas.get_photo().get_file().get_path();
         File? tmp_file = null;
-        var cr = yield FaceDetect.face_detect_proxy.can_read(path);
+        var cr = yield FaceDetect.can_read(path);
         if (!cr) {
             string basename;
             disassemble_filename(canvas.get_photo().get_basename(), out basename, null);
@@ -841,11 +843,15 @@ public class FacesTool : EditingTools.EditingTool {
             path = tmp_file.get_path();
         }
         
+        var photo = canvas.get_photo();
+        var previous = get_previous_in_series(photo);
+
         Error? error = null;
         FaceRect[]? rects = null;
         try {
-            rects = yield FaceDetect.face_detect_proxy.detect_faces(path,
-                        AppDirs.get_haarcascade_file().get_path(), scale_factor, true, face_detection_cancellable);
+            rects = yield FaceDetect.detect_faces(path,
+                        AppDirs.get_haarcascade_file().get_path(), scale_factor, true, photo.get_source_id(),
+                        previous != null ? previous.get_source_id() : null, face_detection_cancellable);
         } catch (Error err) {
             error = err;
         } finally {
@@ -881,6 +887,35 @@ public class FacesTool : EditingTools.EditingTool {
         pick_faces_from_autodetected(faces);
     }
 
+    // Find the photo right before this one in the same event, in the order the
+    // event view sorts them, if it is close enough in time to be part of the
+    // same series
+    private Photo? get_previous_in_series(Photo photo) {
+        var event = photo.get_event();
+        var exposure_time = photo.get_exposure_time();
+        if (event == null || exposure_time == null)
+            return null;
+
+        Photo? previous = null;
+        foreach (MediaSource source in event.get_media()) {
+            var candidate = source as Photo;
+            if (candidate == null || candidate == photo)
+                continue;
+
+            var candidate_time = candidate.get_exposure_time();
+            if (candidate_time == null || MediaSource.compare_exposure_time(candidate, photo) >= 0)
+                continue;
+
+            if (exposure_time.difference(candidate_time) > SERIES_MAX_INTERVAL)
+                continue;
+
+            if (previous == null || MediaSource.compare_exposure_time(candidate, previous) > 0)
+                previous = candidate;
+        }
+
+        return previous;
+    }
+
     private void on_face_detection_done(Object? source, GLib.AsyncResult res) {
         try {
             run_face_detection.end(res);
@@ -10,6 +10,8 @@
     #include <opencv2/dnn.hpp>
 #endif
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
 #include <string>
 #include <filesystem>
@@ -30,6 +32,37 @@ constexpr std::string_view RESNET_DETECT_CAFFE_NET{ "res10_300x300_ssd_iter_1400
 constexpr std::string_view HAARCASCADE{ "haarcascade_frontalface_alt.xml" };
 constexpr std::string_view HAARCASCADE_PROFILE{ "haarcascade_profileface.xml" };
 
+// Frames seen by detectFacesRelated(), so near identical shots of a burst or
+// bracketed series can reuse the faces found on the previous one
+struct SeriesFrame {
+    std::string id;
+    cv::Mat signature;      // Tiny normalized grayscale thumbnail to compare frames
+    cv::Mat gray;           // Reduced grayscale copy to look for the faces in
+    bool infer{ false };
+    int reuses{ 0 };        // Frames in a row that reused faces instead of detecting them
+    std::vector<FaceRect> faces;
+};
+
+static std::deque<SeriesFrame> seriesFrames;
+
+constexpr size_t MAX_SERIES_FRAMES{ 8 };
+constexpr int SIGNATURE_SIZE{ 32 };
+// The signature is compared in SIGNATURE_CELLS x SIGNATURE_CELLS regions, so a
+// change in a small part of the frame is not lost in the overall difference
+constexpr int SIGNATURE_CELLS{ 8 };
+// Mean absolute difference of the signatures, in standard deviations, so
+// exposure changes of a bracketed series do not matter
+constexpr double MAX_SIGNATURE_DIFFERENCE{ 0.15 };
+constexpr double MAX_CELL_DIFFERENCE{ 0.5 };
+// Run the full detection again after this many frames reused their faces, so
+// errors do not carry over through a whole burst
+constexpr int MAX_CHAINED_REUSES{ 3 };
+constexpr int REFINE_SIZE{ 640 };
+// How far, relative to its size, a face may have moved between two frames
+constexpr double REFINE_SEARCH_MARGIN{ 0.5 };
+constexpr double MIN_REFINE_MATCH{ 0.7 };
+constexpr int MIN_REFINE_FACE_SIZE{ 8 };
+
 std::vector<cv::Rect> detectFacesMat(const cv::Mat &img);
 std::vector<double> faceToVecMat(const cv::Mat& img);
 
@@ -37,6 +70,33 @@ bool canRead(const cv::String &inputName) {
     return cv::haveImageReader(inputName);
 }
 
+// Limit the number of worker threads OpenCV may use in this process. Several
+// helpers run side by side, so each one only gets its share of the machine
+void setThreadBudget(int threads) {
+    if (threads <= 0) {
+        return;
+    }
+
+    g_debug("Limiting OpenCV to %d threads", threads);
+    cv::setNumThreads(threads);
+}
+
+static cv::Mat loadImage(const cv::String &inputName) {
+    if (inputName.empty()) {
+        g_warning("No file to process. aborting");
+        return {};
+    }
+
+    cv::Mat img = cv::imread(inputName, 1);
+    if (img.empty()) {
+        g_warning("Failed to load the image file: %s", inputName.c_str());
+    }
+
+    return img;
+}
+
+static std::vector<FaceRect> detectFacesImage(const cv::Mat &img, double scale, bool infer, bool &failed);
+
 // Detect faces in a photo
 std::vector<FaceRect> detectFaces(const cv::String &inputName, double scale, bool infer = false) {
     if(cascade.empty()) {
@@ -44,18 +104,203 @@ std::vector<FaceRect> detectFaces(const cv::String &inputName, double scale, boo
         return {};
     }
 
-	if (inputName.empty()) {
-        g_warning("No file to process. aborting");
+    cv::Mat const img = loadImage(inputName);
+    if (img.empty()) {
         return {};
+    }
+
+    bool failed{ false };
+    return detectFacesImage(img, scale, infer, failed);
+}
+
+static SeriesFrame makeSeriesFrame(const std::string &id, const cv::Mat &img) {
+    SeriesFrame frame;
+    frame.id = id;
+
+    cv::Mat gray;
+    cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+    const double factor = std::min(1.0, static_cast<double>(REFINE_SIZE) / std::max(gray.cols, gray.rows));
+    cv::resize(gray, frame.gray, cv::Size(), factor, factor, cv::INTER_AREA);
+
+    // Remove brightness and contrast from the signature
+    cv::Mat signature;
+    cv::resize(frame.gray, signature, cv::Size(SIGNATURE_SIZE, SIGNATURE_SIZE), 0, 0, cv::INTER_AREA);
+    cv::Scalar mean;
+    cv::Scalar stddev;
+    cv::meanStdDev(signature, mean, stddev);
+    signature.convertTo(frame.signature, CV_32F, 1.0 / std::max(stddev[0], 1.0),
+                        -mean[0] / std::max(stddev[0], 1.0));
+
+    return frame;
+}
+
+static bool isSameScene(const SeriesFrame &previous, const SeriesFrame &frame) {
+    if (previous.gray.size() != frame.gray.size()) {
+        return false;
+    }
+
+    cv::Mat difference;
+    cv::absdiff(previous.signature, frame.signature, difference);
+
+    // Leave out the faces we track, refineFaces() checks those
+    const cv::Rect bounds(0, 0, SIGNATURE_SIZE, SIGNATURE_SIZE);
+    cv::Mat mask(bounds.size(), CV_8UC1, cv::Scalar(255));
+    for (const auto &face : previous.faces) {
+        const cv::Rect rect = cv::Rect(cvFloor(face.x * SIGNATURE_SIZE),
+                                       cvFloor(face.y * SIGNATURE_SIZE),
+                                       cvCeil(face.width * SIGNATURE_SIZE) + 1,
+                                       cvCeil(face.height * SIGNATURE_SIZE) + 1) & bounds;
+        mask(rect).setTo(0);
+    }
+
+    if (cv::countNonZero(mask) == 0) {
+        return true;
+    }
+
+    const double total = cv::mean(difference, mask)[0];
+    g_debug("Difference between %s and %s: %f", previous.id.c_str(), frame.id.c_str(), total);
+    if (total > MAX_SIGNATURE_DIFFERENCE) {
+        return false;
+    }
+
+    // Someone stepping into the frame only changes a small part of it
+    constexpr int CELL_SIZE{ SIGNATURE_SIZE / SIGNATURE_CELLS };
+    for (int y = 0; y < SIGNATURE_SIZE; y += CELL_SIZE) {
+        for (int x = 0; x < SIGNATURE_SIZE; x += CELL_SIZE) {
+            const cv::Rect cell(x, y, CELL_SIZE, CELL_SIZE);
+            if (cv::countNonZero(mask(cell)) == 0) {
+                continue;
+            }
+
+            const double cellDifference = cv::mean(difference(cell), mask(cell))[0];
+            if (cellDifference > MAX_CELL_DIFFERENCE) {
+                g_debug("Region %d,%d of %s changed: %f", x, y, frame.id.c_str(), cellDifference);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Look for each face of the previous frame close to where it was before, keeping
+// its embedding. Fails if any of the faces cannot be found again
+static bool refineFaces(const SeriesFrame &previous, const SeriesFrame &frame, std::vector<FaceRect> &faces) {
+    const cv::Rect bounds(0, 0, frame.gray.cols, frame.gray.rows);
+
+    for (const auto &face : previous.faces) {
+        const cv::Rect templateRect = cv::Rect(cvRound(face.x * bounds.width),
+                                               cvRound(face.y * bounds.height),
+                                               cvRound(face.width * bounds.width),
+                                               cvRound(face.height * bounds.height)) & bounds;
+        if (templateRect.width < MIN_REFINE_FACE_SIZE || templateRect.height < MIN_REFINE_FACE_SIZE) {
+            return false;
+        }
+
+        const int marginX = cvRound(templateRect.width * REFINE_SEARCH_MARGIN);
+        const int marginY = cvRound(templateRect.height * REFINE_SEARCH_MARGIN);
+        const cv::Rect search = cv::Rect(templateRect.x - marginX,
+                                         templateRect.y - marginY,
+                                         templateRect.width + 2 * marginX,
+                                         templateRect.height + 2 * marginY) & bounds;
+
+        cv::Mat result;
+        cv::matchTemplate(frame.gray(search), previous.gray(templateRect), result, cv::TM_CCOEFF_NORMED);
+
+        double match{ 0.0 };
+        cv::Point location;
+        cv::minMaxLoc(result, nullptr, &match, nullptr, &location);
+        if (match < MIN_REFINE_MATCH) {
+            g_debug("Face at %f,%f not found again in %s (%f)", face.x, face.y, frame.id.c_str(), match);
+            return false;
+        }
+
+        FaceRect refined = face;
+        refined.x = static_cast<float>(search.x + location.x) / bounds.width;
+        refined.y = static_cast<float>(search.y + location.y) / bounds.height;
+        faces.push_back(refined);
+    }
+
+    return true;
+}
+
+static void rememberSeriesFrame(SeriesFrame &&frame) {
+    seriesFrames.erase(std::remove_if(seriesFrames.begin(), seriesFrames.end(),
+                                      [&frame](const SeriesFrame &f) { return f.id == frame.id; }),
+                       seriesFrames.end());
+    seriesFrames.push_back(std::move(frame));
+
+    while (seriesFrames.size() > MAX_SERIES_FRAMES) {
+        seriesFrames.pop_front();
+    }
+}
+
+// Detect faces in a photo that is likely part of a series with the photo
+// identified by related. If both look the same, the faces of the related photo
+// are moved to their new position instead of running the detection again
+std::vector<FaceRect> detectFacesRelated(const cv::String &inputName, double scale, bool infer,
+                                         const std::string &id, const std::string &related) {
+    if(cascade.empty()) {
+        g_warning("No cascade file loaded. Did you call loadNet()?");
         return {};
-	}
+    }
 
-    cv::Mat const img = cv::imread(inputName, 1);
-	if (img.empty()) {
-        g_warning("Failed to load the image file: %s", inputName.c_str());
+    cv::Mat const img = loadImage(inputName);
+    if (img.empty()) {
         return {};
-	}
+    }
+
+    SeriesFrame frame;
+    try {
+        frame = makeSeriesFrame(id, img);
+    } catch (cv::Exception& ex) {
+        g_warning("Failed to prepare series frame: %s", ex.what());
+        bool failed{ false };
+        return detectFacesImage(img, scale, infer, failed);
+    }
+
+    bool reused = false;
+    const auto previous = std::find_if(seriesFrames.cbegin(), seriesFrames.cend(),
+                                       [&related](const SeriesFrame &f) { return f.id == related; });
+    // Only reuse frames that had faces. Otherwise a face appearing in an
+    // otherwise identical frame would never be found
+    if (!related.empty() && previous != seriesFrames.cend() && !previous->faces.empty() &&
+        previous->reuses < MAX_CHAINED_REUSES && (previous->infer || !infer) &&
+        isSameScene(*previous, frame)) {
+        try {
+            reused = refineFaces(*previous, frame, frame.faces);
+        } catch (cv::Exception& ex) {
+            g_warning("Refining faces failed: %s", ex.what());
+        }
+
+        if (reused) {
+            g_debug("Reusing %zu faces of %s for %s", frame.faces.size(), related.c_str(), id.c_str());
+            frame.infer = previous->infer;
+            frame.reuses = previous->reuses + 1;
+        } else {
+            frame.faces.clear();
+        }
+    }
+
+    bool failed{ false };
+    if (!reused) {
+        frame.faces = detectFacesImage(img, scale, infer, failed);
+        frame.infer = infer;
+    }
+
+    auto faces = frame.faces;
+
+    // Do not keep failed detections around as frames without faces
+    if (!id.empty() && !failed) {
+        rememberSeriesFrame(std::move(frame));
+    }
+
+    return faces;
+}
 
+// Sets failed if detection or recognition failed, as opposed to finding no faces
+static std::vector<FaceRect> detectFacesImage(const cv::Mat &img, double scale, bool infer, bool &failed) {
+    failed = false;
     std::vector<cv::Rect> faces;
     cv::Size smallImgSize;
 
@@ -117,6 +362,7 @@ std::vector<FaceRect> detectFaces(const cv::String &inputName, double scale, boo
         }
     } catch (cv::Exception& ex) {
         g_warning("Face detection failed: %s", ex.what());
+        failed = true;
         return {};
     }
 
@@ -139,6 +385,7 @@ std::vector<FaceRect> detectFaces(const cv::String &inputName, double scale, boo
         } catch (cv::Exception& ex) {
             g_warning("Face recognition failed: %s", ex.what());
             i.vec = {};
+            failed = true;
         }
 #endif
         scaled.push_back(i);
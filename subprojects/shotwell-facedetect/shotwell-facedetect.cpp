@@ -25,22 +25,39 @@ GVariant *FaceRect::serialize() const
                          g_variant_new_fixed_array(G_VARIANT_TYPE_DOUBLE, vec.data(), vec.size(), sizeof(double)));
 }
 
+static GVariant *serialize_rects(const std::vector<FaceRect> &rects)
+{
+    g_auto(GVariantBuilder) builder = G_VARIANT_BUILDER_INIT(G_VARIANT_TYPE("a(ddddad)"));
+
+    for(const auto &rect : rects) {
+        g_variant_builder_add(&builder, "@(ddddad)", rect.serialize());
+        g_debug("Returning %f,%f-%f", rect.x, rect.y, rect.vec.empty() ? 0.0 : rect.vec.back());
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
 // DBus binding functions
 static gboolean on_handle_detect_faces(ShotwellFaces1 *object, GDBusMethodInvocation *invocation,
                                        [[maybe_unused]]const gchar *arg_image, const gchar *arg_cascade, gdouble arg_scale,
                                        gboolean arg_infer)
 {
-    g_auto(GVariantBuilder) builder = G_VARIANT_BUILDER_INIT(G_VARIANT_TYPE("a(ddddad)"));
     auto rects = detectFaces(arg_image, arg_scale, arg_infer == TRUE);
 
-    // Construct return value
-    for(const auto &rect : rects) {
-        g_variant_builder_add(&builder, "@(ddddad)", rect.serialize());
-        g_debug("Returning %f,%f-%f", rect.x, rect.y, rect.vec.back());
-    }
+    // Call return
+    shotwell_faces1_complete_detect_faces(object, invocation, serialize_rects(rects));
+    return TRUE;
+}
+
+static gboolean on_handle_detect_faces_related(ShotwellFaces1 *object, GDBusMethodInvocation *invocation,
+                                               const gchar *arg_image, [[maybe_unused]] const gchar *arg_cascade,
+                                               gdouble arg_scale, gboolean arg_infer, const gchar *arg_id,
+                                               const gchar *arg_related)
+{
+    auto rects = detectFacesRelated(arg_image, arg_scale, arg_infer == TRUE, arg_id, arg_related);
 
     // Call return
-    shotwell_faces1_complete_detect_faces(object, invocation, g_variant_builder_end(&builder));
+    shotwell_faces1_complete_detect_faces_related(object, invocation, serialize_rects(rects));
     return TRUE;
 }
 
@@ -72,6 +89,7 @@ static void on_name_acquired(GDBusConnection *connection,
 
     auto *interface = shotwell_faces1_skeleton_new();
     g_signal_connect(interface, "handle-detect-faces", G_CALLBACK (on_handle_detect_faces), nullptr);
+    g_signal_connect(interface, "handle-detect-faces-related", G_CALLBACK (on_handle_detect_faces_related), nullptr);
     g_signal_connect(interface, "handle-terminate", G_CALLBACK (on_handle_terminate), user_data);
     g_signal_connect(interface, "handle-load-net", G_CALLBACK (on_handle_load_net), nullptr);
     g_signal_connect(interface, "handle-can-read", G_CALLBACK (on_can_read), nullptr);
@@ -94,9 +112,11 @@ static void on_name_lost(GDBusConnection *connection,
 }
 
 static char* address = nullptr;
+static gint threads = 0;
 
 static GOptionEntry entries[] = {
     { "address", 'a', 0, G_OPTION_ARG_STRING, &address, "Use private DBus ADDRESS instead of session", "ADDRESS" },
+    { "threads", 't', 0, G_OPTION_ARG_INT, &threads, "Use at most THREADS threads for face detection", "THREADS" },
     { nullptr }
 };
 
@@ -138,6 +158,8 @@ int main(int argc, char **argv) {
         exit(1);
     }
 
+    setThreadBudget(threads);
+
     loop = g_main_loop_new (nullptr, FALSE);
 
 
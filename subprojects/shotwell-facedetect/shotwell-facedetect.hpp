@@ -13,6 +13,7 @@
 
 #include <gio/gio.h>
 
+#include <string>
 #include <vector>
 
 struct FaceRect {
@@ -31,4 +32,7 @@ struct FaceRect {
 
 bool loadNet(const cv::String& netFile);
 std::vector<FaceRect> detectFaces(const cv::String& inputName, double scale, bool infer);
+std::vector<FaceRect> detectFacesRelated(const cv::String& inputName, double scale, bool infer,
+                                         const std::string& id, const std::string& related);
 bool canRead(const cv::String& inputName);
+void setThreadBudget(int threads);